@@ -0,0 +1,21 @@
+#!/bin/bash
+# Helpers shared by the benchmark scripts (source, don't run).
+
+# Flattens a benchmark report into "section.key value" lines
+flatten() {
+    awk -F'[":,]+' '
+        /\{$/ && NF > 2 { section = $2 "." }
+        /^  \}/          { section = "" }
+        /: [-0-9.]+,?$/  { gsub(/[ ,]/, "", $3); print section $2, $3 }
+    ' "$1"
+}
+
+# Usage: print_table <label-a> <report-a> <label-b> <report-b>
+print_table() {
+    echo ""
+    printf "%-30s %14s %14s %9s\n" "metric" "$1" "$3" "delta"
+    join <(flatten "$2" | sort) <(flatten "$4" | sort) | \
+        awk '{ d = ($2 != 0) ? sprintf("%+.1f%%", ($3 - $2) / $2 * 100) : "-"; printf "%-30s %14s %14s %9s\n", $1, $2, $3, d }'
+    echo ""
+    echo "Reports: $2 $4"
+}
@@ -0,0 +1,62 @@
+#!/bin/bash
+# Build two revisions in release mode and replay the same benchmark on both.
+# Usage: bash scripts/bench_compare.sh <rev-before> <rev-after> <model> [script] [frames]
+set -e
+source "$(dirname "$0")/bench_common.sh"
+
+if [ $# -lt 3 ]; then
+    echo "Usage: $0 <rev-before> <rev-after> <model> [script] [frames]"
+    exit 1
+fi
+
+export CC=clang-18
+export CXX=clang++-18
+
+REPO_ROOT=$(git rev-parse --show-toplevel)
+MODEL=$(realpath "$3")
+SCRIPT_ARGS=()
+if [ -n "$4" ]; then SCRIPT_ARGS=(--script "$(realpath "$4")"); fi
+# Without an explicit frame count the app runs the full script (or its default orbit)
+FRAME_ARGS=()
+if [ -n "$5" ]; then FRAME_ARGS=(--frames "$5"); fi
+OUT_DIR="$REPO_ROOT/build/bench"
+mkdir -p "$OUT_DIR"
+
+run_revision() {
+    local rev=$1
+    local name=${rev//\//_}
+    local tree="$OUT_DIR/tree-$name"
+
+    echo "🔹 [$rev] Preparing worktree..."
+    rm -rf "$tree"
+    git -C "$REPO_ROOT" worktree prune
+    git -C "$REPO_ROOT" worktree add --detach "$tree" "$rev" > /dev/null
+    # A failed build or an incomplete run exits through set -e: still unregister the worktree
+    trap "git -C \"$REPO_ROOT\" worktree remove --force \"$tree\"" EXIT
+
+    echo "🔹 [$rev] Building..."
+    (
+        cd "$tree"
+        glslc src/shaders/raytrace.comp -o src/shaders/raytrace.comp.spv
+        cmake -S . -B build/release -G "Ninja" -DCMAKE_BUILD_TYPE=release > /dev/null
+        ninja -C build/release RayTracingDemo > /dev/null
+    )
+
+    echo "🔹 [$rev] Running benchmark..."
+    # Shaders are resolved relative to the working directory
+    (
+        cd "$tree"
+        ./build/release/RayTracingDemo --benchmark "$MODEL" "${SCRIPT_ARGS[@]}" \
+            "${FRAME_ARGS[@]}" --seed 1 --output "$OUT_DIR/$name.json" > "$OUT_DIR/$name.log"
+    )
+
+    git -C "$REPO_ROOT" worktree remove --force "$tree"
+    trap - EXIT
+}
+
+run_revision "$1"
+run_revision "$2"
+BEFORE="$OUT_DIR/${1//\//_}.json"
+AFTER="$OUT_DIR/${2//\//_}.json"
+
+print_table "$1" "$BEFORE" "$2" "$AFTER"
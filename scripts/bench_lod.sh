@@ -0,0 +1,34 @@
+#!/bin/bash
+# Replay the same benchmark with cluster LOD off and on using the current release build.
+# Usage (from the repo root): bash scripts/bench_lod.sh <model> [script] [frames] [lod-threshold-px]
+set -e
+source "$(dirname "$0")/bench_common.sh"
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <model> [script] [frames] [lod-threshold-px]"
+    exit 1
+fi
+
+BIN=./build/release/RayTracingDemo
+if [ ! -x "$BIN" ]; then
+    echo "Missing $BIN, run scripts/build_release.sh first."
+    exit 1
+fi
+
+SCRIPT_ARGS=()
+if [ -n "$2" ]; then SCRIPT_ARGS=(--script "$2"); fi
+# Without an explicit frame count the app runs the full script (or its default orbit)
+FRAME_ARGS=()
+if [ -n "$3" ]; then FRAME_ARGS=(--frames "$3"); fi
+THRESHOLD=${4:-4}
+OUT_DIR=build/bench
+mkdir -p "$OUT_DIR"
+
+for mode in off on; do
+    echo "🔹 Running benchmark with LOD $mode (threshold ${THRESHOLD}px)..."
+    "$BIN" --benchmark "$1" "${SCRIPT_ARGS[@]}" "${FRAME_ARGS[@]}" --seed 1 \
+        --lod "$mode" --lod-threshold "$THRESHOLD" \
+        --output "$OUT_DIR/lod-$mode.json" > "$OUT_DIR/lod-$mode.log"
+done
+
+print_table "lod-off" "$OUT_DIR/lod-off.json" "lod-on" "$OUT_DIR/lod-on.json"
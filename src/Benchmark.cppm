@@ -0,0 +1,339 @@
+module;
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+export module Benchmark;
+
+import Types;
+
+export namespace Benchmark
+{
+    // Consecutive unpresented frames before an unattended run gives up (report marked incomplete)
+    constexpr int MAX_PRESENT_RETRIES = 120;
+
+    // Command line configuration. Benchmark mode is enabled by --benchmark <model>.
+    struct Options {
+        bool enabled = false;
+        std::string modelPath;
+        std::string scriptPath;                    // Empty -> built-in orbit
+        std::string outputPath = "benchmark.json"; // "-" -> stdout
+        std::string recordPath;                    // Interactive mode: dump camera/light state per frame
+        int frames = 600;                          // With --script: defaults to the last keyframe + 1
+        bool framesGiven = false;
+        int warmup = 60;
+        int seed = 0;
+        bool lod = true;
+        float lodPixelThreshold = 4.0f;
+    };
+
+    // One scripted state of UI::settings.
+    // camDistance is relative to the model's largest extent so scripts are portable between models.
+    struct Keyframe {
+        int frame = 0;
+        float camAzimuth = 0.0f;
+        float camElevation = 0.5f;
+        float camDistance = 1.0f;
+        int maxBounces = 2;
+        float light1Color[3] = {0.0f, 0.0f, 0.0f};
+        float light1Pos[3] = {0.0f, 0.0f, 0.0f};
+        float light2Color[3] = {0.0f, 0.0f, 0.0f};
+        float light2Pos[3] = {0.0f, 0.0f, 0.0f};
+    };
+
+    struct LoadTimings {
+        double meshMs = 0.0;
+        double boundsMs = 0.0;
+        double cacheMs = 0.0;
+        double bvhMs = 0.0;
+        double gpuFormatMs = 0.0;
+        double lodMs = 0.0;
+        double uploadMs = 0.0;
+    };
+
+    struct FrameStats {
+        size_t count = 0;
+        double avgMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+    };
+
+    struct Report {
+        std::string modelPath;
+        std::string scriptPath;
+        int frames = 0;
+        int warmup = 0;
+        int seed = 0;
+        uint width = 0;
+        uint height = 0;
+        size_t triangles = 0;
+        size_t lodTriangles = 0;
+        size_t bvhNodes = 0;
+        bool lod = true;
+        float lodPixelThreshold = 0.0f;
+        bool completed = true;
+        LoadTimings load;
+        FrameStats frameTimes;
+    };
+
+    double elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void print_usage(const char* exe) {
+        std::cout << "Usage: " << exe << " [--record <file>]\n"
+                  << "       " << exe << " --benchmark <model> [--script <file>] [--frames N] [--warmup N] [--seed N] [--lod on|off] [--lod-threshold PX] [--output <file>]\n";
+    }
+
+    template <typename T>
+    bool parse_value(const char* text, T& out) {
+        std::istringstream in(text);
+        in >> out;
+        return !in.fail() && in.eof();
+    }
+
+    bool parse_args(int argc, char** argv, Options& out) {
+        std::string benchmarkOnlyArg;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+            bool ok = value != nullptr;
+            if (arg == "--benchmark" && ok) { out.enabled = true; out.modelPath = value; }
+            else if (arg == "--script" && ok) out.scriptPath = value;
+            else if (arg == "--output" && ok) out.outputPath = value;
+            else if (arg == "--record" && ok) out.recordPath = value;
+            else if (arg == "--frames" && ok) { ok = parse_value(value, out.frames) && out.frames > 0; out.framesGiven = true; }
+            else if (arg == "--warmup" && ok) ok = parse_value(value, out.warmup) && out.warmup >= 0;
+            else if (arg == "--seed" && ok) ok = parse_value(value, out.seed);
+            else if (arg == "--lod" && ok) { out.lod = std::string(value) == "on"; ok = out.lod || std::string(value) == "off"; }
+            else if (arg == "--lod-threshold" && ok) ok = parse_value(value, out.lodPixelThreshold) && out.lodPixelThreshold > 0.0f;
+            else ok = false;
+
+            if (!ok) {
+                std::cerr << "[Benchmark] Invalid argument: " << arg << "\n";
+                print_usage(argv[0]);
+                return false;
+            }
+            if (arg != "--benchmark" && arg != "--record") benchmarkOnlyArg = arg;
+            ++i;
+        }
+
+        // Reject combinations that would otherwise be silently ignored
+        if (!out.enabled && !benchmarkOnlyArg.empty()) {
+            std::cerr << "[Benchmark] " << benchmarkOnlyArg << " requires --benchmark\n";
+            print_usage(argv[0]);
+            return false;
+        }
+        if (out.enabled && !out.recordPath.empty()) {
+            std::cerr << "[Benchmark] --record cannot be combined with --benchmark\n";
+            print_usage(argv[0]);
+            return false;
+        }
+        return true;
+    }
+
+    // Line format (whitespace separated, '#' starts a comment):
+    //   frame azimuth elevation distance bounces [l1.rgb l1.xyz l2.rgb l2.xyz]
+    // Omitted light columns are taken from 'base'.
+    bool parse_keyframe(const std::string& line, const Keyframe& base, Keyframe& out) {
+        std::istringstream in(line.substr(0, line.find('#')));
+        out = base;
+        if (!(in >> out.frame >> out.camAzimuth >> out.camElevation >> out.camDistance >> out.maxBounces)) return false;
+
+        float lights[12];
+        int n = 0;
+        while (n < 12 && in >> lights[n]) n++;
+        if (n == 0 && in.eof()) return true;
+        if (n != 12 || !(in >> std::ws).eof()) return false;
+
+        std::copy(lights + 0, lights + 3, out.light1Color);
+        std::copy(lights + 3, lights + 6, out.light1Pos);
+        std::copy(lights + 6, lights + 9, out.light2Color);
+        std::copy(lights + 9, lights + 12, out.light2Pos);
+        return true;
+    }
+
+    std::string format_keyframe(const Keyframe& k) {
+        std::ostringstream out;
+        out << std::setprecision(6) << k.frame << " " << k.camAzimuth << " " << k.camElevation << " " << k.camDistance << " " << k.maxBounces;
+        for (const float* v : { k.light1Color, k.light1Pos, k.light2Color, k.light2Pos })
+            out << " " << v[0] << " " << v[1] << " " << v[2];
+        return out.str();
+    }
+
+    bool load_script(const std::string& path, const Keyframe& base, std::vector<Keyframe>& out) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "[Benchmark] Failed to open script: " << path << "\n";
+            return false;
+        }
+
+        out.clear();
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(file, line)) {
+            lineNo++;
+            size_t firstChar = line.find_first_not_of(" \t\r");
+            if (firstChar == std::string::npos || line[firstChar] == '#') continue;
+
+            Keyframe k;
+            if (!parse_keyframe(line, base, k)) {
+                std::cerr << "[Benchmark] " << path << ":" << lineNo << ": malformed keyframe\n";
+                return false;
+            }
+            if (k.frame < 0 || (!out.empty() && k.frame <= out.back().frame)) {
+                std::cerr << "[Benchmark] " << path << ":" << lineNo << ": frames must be non-negative and strictly increasing\n";
+                return false;
+            }
+            out.push_back(k);
+        }
+
+        if (out.empty()) {
+            std::cerr << "[Benchmark] Script has no keyframes: " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Full azimuth turn over the run, everything else held at 'base'.
+    std::vector<Keyframe> default_orbit(const Keyframe& base, int frames) {
+        Keyframe first = base;
+        first.frame = 0;
+        first.camAzimuth = 0.0f;
+
+        Keyframe last = first;
+        last.frame = std::max(frames - 1, 1);
+        last.camAzimuth = 6.2831853f;
+        return { first, last };
+    }
+
+    // Linear interpolation between surrounding keyframes; bounces step at the earlier key.
+    Keyframe sample(const std::vector<Keyframe>& keys, int frame) {
+        if (keys.empty()) return Keyframe{ .frame = frame };
+        if (frame <= keys.front().frame) return keys.front();
+        if (frame >= keys.back().frame) return keys.back();
+
+        auto next = std::upper_bound(keys.begin(), keys.end(), frame, [](int f, const Keyframe& k) { return f < k.frame; });
+        const Keyframe& a = *(next - 1);
+        const Keyframe& b = *next;
+        float t = static_cast<float>(frame - a.frame) / static_cast<float>(b.frame - a.frame);
+        auto lerp = [t](float x, float y) { return x + (y - x) * t; };
+
+        Keyframe k = a;
+        k.frame = frame;
+        k.camAzimuth = lerp(a.camAzimuth, b.camAzimuth);
+        k.camElevation = lerp(a.camElevation, b.camElevation);
+        k.camDistance = lerp(a.camDistance, b.camDistance);
+        for (int i = 0; i < 3; ++i) {
+            k.light1Color[i] = lerp(a.light1Color[i], b.light1Color[i]);
+            k.light1Pos[i] = lerp(a.light1Pos[i], b.light1Pos[i]);
+            k.light2Color[i] = lerp(a.light2Color[i], b.light2Color[i]);
+            k.light2Pos[i] = lerp(a.light2Pos[i], b.light2Pos[i]);
+        }
+        return k;
+    }
+
+    // Nearest-rank percentiles over the collected frame times
+    FrameStats compute_stats(std::vector<double> samples) {
+        FrameStats s;
+        if (samples.empty()) return s;
+
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p) {
+            size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+            return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+        };
+
+        double sum = 0.0;
+        for (double v : samples) sum += v;
+
+        s.count = samples.size();
+        s.avgMs = sum / samples.size();
+        s.minMs = samples.front();
+        s.maxMs = samples.back();
+        s.p50Ms = percentile(50.0);
+        s.p95Ms = percentile(95.0);
+        s.p99Ms = percentile(99.0);
+        return s;
+    }
+
+    // One key per line so the output stays easy to diff and grep from scripts
+    void write_json(std::ostream& out, const Report& r) {
+        auto escape = [](const std::string& s) {
+            std::string e;
+            for (char c : s) {
+                if (c == '"' || c == '\\') e += '\\';
+                e += c;
+            }
+            return e;
+        };
+
+        // One primary ray per pixel; bounce rays depend on the scene and are not counted
+        double primaryRaysPerSec = r.frameTimes.avgMs > 0.0 ? (double)r.width * r.height * 1000.0 / r.frameTimes.avgMs : 0.0;
+
+        out << std::fixed << std::setprecision(4)
+            << "{\n"
+            << "  \"model\": \"" << escape(r.modelPath) << "\",\n"
+            << "  \"script\": \"" << escape(r.scriptPath.empty() ? "builtin-orbit" : r.scriptPath) << "\",\n"
+            << "  \"frames\": " << r.frames << ",\n"
+            << "  \"warmup\": " << r.warmup << ",\n"
+            << "  \"seed\": " << r.seed << ",\n"
+            << "  \"completed\": " << (r.completed ? "true" : "false") << ",\n"
+            << "  \"lod\": " << (r.lod ? "true" : "false") << ",\n"
+            << "  \"lod_pixel_threshold\": " << r.lodPixelThreshold << ",\n"
+            << "  \"resolution\": [" << r.width << ", " << r.height << "],\n"
+            << "  \"triangles\": " << r.triangles << ",\n"
+            << "  \"lod_triangles\": " << r.lodTriangles << ",\n"
+            << "  \"bvh_nodes\": " << r.bvhNodes << ",\n"
+            << "  \"gpu_memory_bytes\": {\n"
+            << "    \"triangles\": " << (r.triangles + r.lodTriangles) * sizeof(RaytraceTriangle) << ",\n"
+            << "    \"bvh\": " << r.bvhNodes * sizeof(BVHNode) << ",\n"
+            << "    \"total\": " << (r.triangles + r.lodTriangles) * sizeof(RaytraceTriangle) + r.bvhNodes * sizeof(BVHNode) << "\n"
+            << "  },\n"
+            << "  \"primary_rays_per_sec\": " << primaryRaysPerSec << ",\n"
+            << "  \"load_ms\": {\n"
+            << "    \"mesh\": " << r.load.meshMs << ",\n"
+            << "    \"bounds\": " << r.load.boundsMs << ",\n"
+            << "    \"cache\": " << r.load.cacheMs << ",\n"
+            << "    \"bvh\": " << r.load.bvhMs << ",\n"
+            << "    \"gpu_format\": " << r.load.gpuFormatMs << ",\n"
+            << "    \"lod\": " << r.load.lodMs << ",\n"
+            << "    \"upload\": " << r.load.uploadMs << "\n"
+            << "  },\n"
+            << "  \"frame_ms\": {\n"
+            << "    \"count\": " << r.frameTimes.count << ",\n"
+            << "    \"avg\": " << r.frameTimes.avgMs << ",\n"
+            << "    \"min\": " << r.frameTimes.minMs << ",\n"
+            << "    \"max\": " << r.frameTimes.maxMs << ",\n"
+            << "    \"p50\": " << r.frameTimes.p50Ms << ",\n"
+            << "    \"p95\": " << r.frameTimes.p95Ms << ",\n"
+            << "    \"p99\": " << r.frameTimes.p99Ms << "\n"
+            << "  }\n"
+            << "}\n";
+    }
+
+    bool write_report(const std::string& path, const Report& r) {
+        if (path.empty() || path == "-") {
+            write_json(std::cout, r);
+            return true;
+        }
+
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "[Benchmark] Failed to write report: " << path << "\n";
+            return false;
+        }
+        write_json(file, r);
+        std::cout << "[Benchmark] Report written to " << path << "\n";
+        return true;
+    }
+}
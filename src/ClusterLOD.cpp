@@ -0,0 +1,241 @@
+module;
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <iostream>
+module Engine;
+
+import Types;
+
+namespace Core
+{
+    struct CellPick
+    {
+        u16vec3 v;
+        uint64_t dist = 0;
+        bool used = false;
+    };
+
+    struct ProxyCandidate
+    {
+        std::array<uint, 3> cells;
+        vec3 normalSum;
+    };
+
+    // BVH partitioning is in-place, so every subtree covers a contiguous range of indices
+    SubtreeRange subtree_range(uint nodeIdx, const std::vector<BVHNode>& nodes)
+    {
+        const BVHNode& node = nodes[nodeIdx];
+        if (node.triCount > 0 && (node.triCount & BVH_LOD_FLAG) == 0) return { node.leftFirst, node.triCount };
+
+        SubtreeRange left = subtree_range(node.leftFirst, nodes);
+        SubtreeRange right = subtree_range(node.leftFirst + 1, nodes);
+        return { left.first, left.count + right.count };
+    }
+
+    int lod_level(uint triCount)
+    {
+        if (triCount < LOD_CLUSTER_SIZE) return -1;
+        int level = 0;
+        for (uint size = LOD_CLUSTER_SIZE * LOD_LEVEL_RATIO; size <= triCount; size *= LOD_LEVEL_RATIO) level++;
+        return level;
+    }
+
+    // Vertex clustering over a grid on the node bounds. Each cell is represented by its source vertex
+    // farthest from the cluster centroid: it lies on the surface and inside the node, and pulls the
+    // proxy outline out to the cluster's border instead of shrinking it by half a cell on every side.
+    bool simplify_cluster(const Object& obj, const std::vector<RaytraceTriangle>& source, SubtreeRange range, const BVHNode& node,
+                          int grid, uint budget, std::vector<RaytraceTriangle>& out)
+    {
+        const float sx = grid / float(node.aabbMax.x - node.aabbMin.x + 1u);
+        const float sy = grid / float(node.aabbMax.y - node.aabbMin.y + 1u);
+        const float sz = grid / float(node.aabbMax.z - node.aabbMin.z + 1u);
+
+        auto cell_of = [&](const u16vec3& v) {
+            uint cx = std::min<uint>(grid - 1, static_cast<uint>((v.x - node.aabbMin.x) * sx));
+            uint cy = std::min<uint>(grid - 1, static_cast<uint>((v.y - node.aabbMin.y) * sy));
+            uint cz = std::min<uint>(grid - 1, static_cast<uint>((v.z - node.aabbMin.z) * sz));
+            return (cx * grid + cy) * grid + cz;
+        };
+
+        const uint cellCount = grid * grid * grid;
+        std::unordered_map<uint, uint> slots; // Sorted cell triple -> index in merged
+        std::vector<ProxyCandidate> merged;
+
+        for (uint i = 0; i < range.count; ++i) {
+            const RaytraceTriangle& tri = source[range.first + i];
+            std::array<uint, 3> c = { cell_of(tri.v1), cell_of(tri.v2), cell_of(tri.v3) };
+            if (c[0] == c[1] || c[1] == c[2] || c[0] == c[2]) continue;
+            std::sort(c.begin(), c.end());
+
+            // Merge duplicates, summing normals so the proxy faces the dominant direction
+            auto [slot, inserted] = slots.try_emplace((c[0] * cellCount + c[1]) * cellCount + c[2], static_cast<uint>(merged.size()));
+            if (!inserted) {
+                merged[slot->second].normalSum = add(merged[slot->second].normalSum, decode_normal(tri.normal));
+                continue;
+            }
+            if (merged.size() == budget) return false;
+            merged.push_back({ c, decode_normal(tri.normal) });
+        }
+
+        if (merged.empty()) return false;
+
+        vec3 extent = sub(obj.bounds.maxPos, obj.bounds.minPos);
+        auto to_world = [&](const u16vec3& q) {
+            return vec3{
+                obj.bounds.minPos.x + q.x / 65535.0f * extent.x,
+                obj.bounds.minPos.y + q.y / 65535.0f * extent.y,
+                obj.bounds.minPos.z + q.z / 65535.0f * extent.z
+            };
+        };
+
+        auto area = [&](const u16vec3& a, const u16vec3& b, const u16vec3& c) {
+            vec3 pa = to_world(a);
+            vec3 n = cross(sub(to_world(b), pa), sub(to_world(c), pa));
+            return 0.5f * std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        };
+
+        uint64_t sumX = 0, sumY = 0, sumZ = 0;
+        float sourceArea = 0.0f;
+        for (uint i = 0; i < range.count; ++i) {
+            const RaytraceTriangle& tri = source[range.first + i];
+            sumX += tri.v1.x + tri.v2.x + tri.v3.x;
+            sumY += tri.v1.y + tri.v2.y + tri.v3.y;
+            sumZ += tri.v1.z + tri.v2.z + tri.v3.z;
+            sourceArea += area(tri.v1, tri.v2, tri.v3);
+        }
+        const int64_t centerX = sumX / (3 * range.count), centerY = sumY / (3 * range.count), centerZ = sumZ / (3 * range.count);
+
+        std::vector<CellPick> cells(cellCount);
+        for (uint i = 0; i < range.count; ++i) {
+            const RaytraceTriangle& tri = source[range.first + i];
+            for (const u16vec3& v : { tri.v1, tri.v2, tri.v3 }) {
+                int64_t dx = v.x - centerX, dy = v.y - centerY, dz = v.z - centerZ;
+                uint64_t dist = dx * dx + dy * dy + dz * dz;
+                CellPick& pick = cells[cell_of(v)];
+                if (!pick.used || dist > pick.dist) pick = { v, dist, true };
+            }
+        }
+
+        out.clear();
+        out.reserve(merged.size());
+        float proxyArea = 0.0f;
+        for (const auto& m : merged) {
+            RaytraceTriangle proxy = { cells[m.cells[0]].v, cells[m.cells[1]].v, cells[m.cells[2]].v, {} };
+
+            // Opposite faces (thin walls, leaves) cancel out: use the proxy's own geometric normal
+            const vec3& sum = m.normalSum;
+            vec3 normal = normalize(sum);
+            if (std::sqrt(sum.x * sum.x + sum.y * sum.y + sum.z * sum.z) < 0.5f) {
+                vec3 p1 = to_world(proxy.v1);
+                normal = normalize(cross(sub(to_world(proxy.v2), p1), sub(to_world(proxy.v3), p1)));
+                if (normal.x == 0.0f && normal.y == 0.0f && normal.z == 0.0f) continue; // Collapsed to a line
+            }
+            proxy.normal = encode_normal(normal);
+            out.push_back(proxy);
+            proxyArea += area(proxy.v1, proxy.v2, proxy.v3);
+        }
+
+        // Too coarse to stand in for the cluster: rays would fall through the holes
+        return !out.empty() && proxyArea >= LOD_MIN_AREA * sourceArea;
+    }
+
+    // Proxies get their own small BVH (median split) so a cluster costs a few node visits,
+    // not a test against every proxy triangle
+    void split_proxy_node(uint nodeIdx, std::vector<BVHNode>& nodes, std::vector<RaytraceTriangle>& gpu_triangles)
+    {
+        BVHNode& node = nodes[nodeIdx];
+        node.aabbMin = {65535, 65535, 65535};
+        node.aabbMax = {0, 0, 0};
+        for (uint i = 0; i < node.triCount; ++i) {
+            const RaytraceTriangle& tri = gpu_triangles[node.leftFirst + i];
+            for (const u16vec3& v : { tri.v1, tri.v2, tri.v3 }) {
+                node.aabbMin = { std::min(node.aabbMin.x, v.x), std::min(node.aabbMin.y, v.y), std::min(node.aabbMin.z, v.z) };
+                node.aabbMax = { std::max(node.aabbMax.x, v.x), std::max(node.aabbMax.y, v.y), std::max(node.aabbMax.z, v.z) };
+            }
+        }
+
+        if (node.triCount <= LOD_PROXY_LEAF) return;
+
+        int ex = node.aabbMax.x - node.aabbMin.x, ey = node.aabbMax.y - node.aabbMin.y, ez = node.aabbMax.z - node.aabbMin.z;
+        int axis = (ey > ex && ey >= ez) ? 1 : (ez > ex && ez > ey) ? 2 : 0;
+        auto key = [axis](const RaytraceTriangle& t) {
+            if (axis == 0) return t.v1.x + t.v2.x + t.v3.x;
+            if (axis == 1) return t.v1.y + t.v2.y + t.v3.y;
+            return t.v1.z + t.v2.z + t.v3.z;
+        };
+
+        uint first = node.leftFirst;
+        uint count = node.triCount;
+        uint half = count / 2;
+        auto begin = gpu_triangles.begin() + first;
+        std::nth_element(begin, begin + half, begin + count,
+            [&](const RaytraceTriangle& a, const RaytraceTriangle& b) { return key(a) < key(b); });
+
+        // Note: vector reallocation invalidates 'node' reference!
+        uint leftChildIdx = static_cast<uint>(nodes.size());
+        nodes.emplace_back();
+        nodes.emplace_back();
+
+        nodes[nodeIdx].leftFirst = leftChildIdx;
+        nodes[nodeIdx].triCount = 0;
+        nodes[leftChildIdx].leftFirst = first;
+        nodes[leftChildIdx].triCount = half;
+        nodes[leftChildIdx + 1].leftFirst = first + half;
+        nodes[leftChildIdx + 1].triCount = count - half;
+
+        split_proxy_node(leftChildIdx, nodes, gpu_triangles);
+        split_proxy_node(leftChildIdx + 1, nodes, gpu_triangles);
+    }
+
+    uint attach_lod(uint nodeIdx, int parentLevel, const Object& obj,
+                    std::vector<BVHNode>& nodes, std::vector<RaytraceTriangle>& gpu_triangles, std::vector<RaytraceTriangle>& scratch)
+    {
+        if (nodes[nodeIdx].triCount > 0) return 0; // Leaves are traced at full resolution
+
+        uint added = 0;
+        SubtreeRange range = subtree_range(nodeIdx, nodes);
+        int level = lod_level(range.count);
+
+        // A cluster starts wherever the subtree drops into a new size class
+        if (level >= 0 && level != parentLevel) {
+            // The node is only traced through its proxy when it covers a few pixels, so
+            // about one cell per pixel is all the detail the proxy needs
+            uint budget = std::min(range.count / LOD_REDUCTION, LOD_MAX_PROXY);
+            for (int grid = LOD_GRID; grid >= 2; --grid) {
+                if (simplify_cluster(obj, gpu_triangles, range, nodes[nodeIdx], grid, budget, scratch)) {
+                    uint root = static_cast<uint>(nodes.size());
+                    nodes.emplace_back();
+                    nodes[root].leftFirst = static_cast<uint>(gpu_triangles.size());
+                    nodes[root].triCount = static_cast<uint>(scratch.size());
+                    gpu_triangles.insert(gpu_triangles.end(), scratch.begin(), scratch.end());
+                    split_proxy_node(root, nodes, gpu_triangles);
+
+                    nodes[nodeIdx].triCount = BVH_LOD_FLAG | root;
+                    nodes[nodeIdx].lodCount = static_cast<unsigned short>(scratch.size());
+                    added += static_cast<uint>(scratch.size());
+                    break;
+                }
+            }
+        }
+
+        uint left = nodes[nodeIdx].leftFirst;
+        added += attach_lod(left, level, obj, nodes, gpu_triangles, scratch);
+        added += attach_lod(left + 1, level, obj, nodes, gpu_triangles, scratch);
+        return added;
+    }
+
+    uint build_lod(const Object& obj, std::vector<BVHNode>& nodes, std::vector<RaytraceTriangle>& gpu_triangles)
+    {
+        if (nodes.empty() || obj.mesh.empty()) return 0;
+
+        std::vector<RaytraceTriangle> scratch;
+        uint added = attach_lod(0, -1, obj, nodes, gpu_triangles, scratch);
+
+        std::cout << "Cluster LOD Generated: " << added << " proxy triangles ("
+                  << (100.0f * added / obj.mesh.size()) << "% of source)." << std::endl;
+        return added;
+    }
+}
@@ -7,6 +7,24 @@ import Types;
 
 export namespace Core
 {
+    // Cluster LOD tuning
+    constexpr uint LOD_CLUSTER_SIZE = 256; // Smallest subtree that becomes a cluster
+    // Subtree size step between LOD levels: a cluster about every second BVH level, so a node that
+    // covers a few pixels is usually within two levels of a proxy. Smaller clusters cannot be simplified
+    // into a few triangles without holes, denser levels mostly add memory.
+    constexpr uint LOD_LEVEL_RATIO = 4;
+    constexpr uint LOD_REDUCTION = 16;     // Proxy never exceeds subtree triangles / LOD_REDUCTION
+    constexpr uint LOD_MAX_PROXY = 32;     // Proxies are only traced at a few pixels, keep them tiny
+    constexpr int LOD_GRID = 4;            // Cells per axis, about one cell per pixel at the default threshold
+    constexpr float LOD_MIN_AREA = 0.9f;   // Proxy must keep this fraction of the cluster's surface area
+    constexpr uint LOD_PROXY_LEAF = 2;     // Proxy triangles per leaf of a cluster's proxy BVH
+
+    struct SubtreeRange
+    {
+        uint first;
+        uint count;
+    };
+
     bool load_mesh(const std::string& model_path, std::vector<Triangle>& out_triangles, MeshBounds& out_bounds);
 
     bool load_bounds(const std::vector<Triangle>& triangles, MeshBounds& bounds);
@@ -14,4 +32,12 @@ export namespace Core
     bool load_cache(const std::vector<Triangle>& triangles, Object& cache);
 
     void build_bvh(const Object& obj, std::vector<uint>& out_indices, std::vector<BVHNode>& out_nodes);
+
+    // Triangle index range covered by a BVH subtree (LOD-flagged nodes are walked as internal nodes)
+    SubtreeRange subtree_range(uint nodeIdx, const std::vector<BVHNode>& nodes);
+
+    // gpu_triangles must hold the source triangles in BVH order (see Render::write_in_order).
+    // Appends simplified cluster proxies to it, builds a small BVH over each one at the end of nodes
+    // and links its root from the cluster node. Returns proxy count.
+    uint build_lod(const Object& obj, std::vector<BVHNode>& nodes, std::vector<RaytraceTriangle>& gpu_triangles);
 }
\ No newline at end of file
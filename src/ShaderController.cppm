@@ -49,6 +49,9 @@ export namespace Render
     int currentFrame = 0; 
     const int MAX_FRAMES = 2;
 
+    // Frame count serves as a running seed for RNG (benchmark mode resets it to a fixed seed)
+    int frameIndex = 0;
+
     // --- Helpers ---
     void compile_shader_if_needed() {
         int result = std::system("glslc src/shaders/raytrace.comp -o src/shaders/raytrace.comp.spv");
@@ -274,9 +277,7 @@ export namespace Render
         pc.camUp[1] = 0.0f;
         pc.camUp[2] = UI::settings.flipUp ? -1.0f : 1.0f;
 
-        // Frame count serves as a running seed for RNG
-        static int accFrame = 0;
-        pc.frameCount = accFrame++; 
+        pc.frameCount = frameIndex++; 
         
         vkCmdPushConstants(cb, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
 
@@ -290,10 +291,11 @@ export namespace Render
         vkEndCommandBuffer(cb);
     }
 
-    void draw_frame(const MeshBounds& bounds) {
+    // Returns false if no frame was rendered (swapchain out of date)
+    bool draw_frame(const MeshBounds& bounds) {
         vkWaitForFences(Render::device, 1, &fltFen[currentFrame], VK_TRUE, UINT64_MAX);
         uint32_t ii; VkResult r = vkAcquireNextImageKHR(Render::device, Render::swapChain, UINT64_MAX, imgSem[currentFrame], VK_NULL_HANDLE, &ii);
-        if(r == VK_ERROR_OUT_OF_DATE_KHR) return; else check(r == VK_SUCCESS || r == VK_SUBOPTIMAL_KHR, "Swapchain acquire failed");
+        if(r == VK_ERROR_OUT_OF_DATE_KHR) return false; else check(r == VK_SUCCESS || r == VK_SUBOPTIMAL_KHR, "Swapchain acquire failed");
         
         if (uboMappedData) {
             SceneSettingsUBO ubo{};
@@ -302,6 +304,8 @@ export namespace Render
             ubo.light1Pos = {UI::settings.light1Pos[0], UI::settings.light1Pos[1], UI::settings.light1Pos[2], 0.0f};
             ubo.light2Pos = {UI::settings.light2Pos[0], UI::settings.light2Pos[1], UI::settings.light2Pos[2], 0.0f};
             ubo.maxBounces = UI::settings.maxBounces;
+            ubo.lodEnabled = UI::settings.lodEnabled ? 1 : 0;
+            ubo.lodPixelThreshold = UI::settings.lodPixelThreshold;
             memcpy(uboMappedData, &ubo, sizeof(SceneSettingsUBO));
         }
 
@@ -317,5 +321,6 @@ export namespace Render
         VkPresentInfoKHR pi = { .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR, .waitSemaphoreCount = 1, .pWaitSemaphores = &renSem[currentFrame], .swapchainCount = 1, .pSwapchains = &Render::swapChain, .pImageIndices = &ii };
         vkQueuePresentKHR(Render::presentQueue, &pi);
         currentFrame = (currentFrame + 1) % MAX_FRAMES;
+        return true;
     }
 }
\ No newline at end of file
@@ -43,7 +43,7 @@ namespace Core
     void split_bvh_node(uint nodeIdx, const Object& obj, std::vector<uint>& indices, std::vector<BVHNode>& nodes, int depth)
     {
         BVHNode& node = nodes[nodeIdx];
-        node.pad1 = 0; 
+        node.lodCount = 0; 
         node.pad2 = 0;
         
         node.aabbMin = {65535, 65535, 65535};
@@ -92,17 +92,21 @@ export bool operator==(const MeshBounds& a, const MeshBounds& b)
             a.maxPos.x == b.maxPos.x && a.maxPos.y == b.maxPos.y && a.maxPos.z == b.maxPos.z);
 }
 
+// Set in triCount of an internal node that owns a cluster LOD proxy.
+// The remaining bits hold the root of the proxy's own BVH, lodCount holds the number of proxies.
+export constexpr uint BVH_LOD_FLAG = 0x80000000u;
+
 // TODO: OPTIMIZATION: Pack this structure tighter if possible, or align to 16 bytes for GPU fetch efficiency.
 export struct BVHNode
 {
     u16vec3 aabbMin;
-    unsigned short pad1; 
+    unsigned short lodCount; 
     
     u16vec3 aabbMax;
     unsigned short pad2; 
     
     uint32_t leftFirst;
-    uint32_t triCount;
+    uint32_t triCount; // Leaf: triangle count. Internal: 0 or BVH_LOD_FLAG | proxy BVH root
 }; // 24 bytes
 
 export struct Object
@@ -120,7 +124,9 @@ export struct SceneSettingsUBO
     vec4 light1Pos;   // XYZ relative (0-1), w unused
     vec4 light2Pos;   // XYZ relative (0-1), w unused
     int maxBounces;
-    int padding[3];   // Pad to 16 bytes alignment
+    int lodEnabled;
+    float lodPixelThreshold; // Max node size in pixels traced through its LOD proxy
+    int padding;      // Pad to 16 bytes alignment
 };
 
 
@@ -171,6 +177,15 @@ export u16vec3 quantize_position(const vec3& p, const vec3& min_b, const vec3& e
     };
 }
 
+export vec3 decode_normal(const u16vec3& n)
+{
+    return {
+        n.x / 65535.0f * 2.0f - 1.0f,
+        n.y / 65535.0f * 2.0f - 1.0f,
+        n.z / 65535.0f * 2.0f - 1.0f
+    };
+}
+
 export u16vec3 encode_normal(const vec3& n)
 {
     float nx = (n.x + 1.0f) * 0.5f;
@@ -20,6 +20,8 @@ export namespace UI
     // Application Settings
     struct Settings {
         int maxBounces = 2;
+        bool lodEnabled = true;          // Proxies are only generated if enabled at load time
+        float lodPixelThreshold = 4.0f;  // Nodes smaller than this on screen use their cluster proxy
         float light1Color[3] = {0.851f, 0.7569f, 0.5412f};
         float light2Color[3] = {0.3294f, 0.451f, 0.4706f};
         float light1Pos[3] = {0.0f, 0.0f, 0.0f}; // relative 0.0-1.0
@@ -52,6 +54,13 @@ export namespace UI
         return ImGui::GetIO().WantCaptureMouse;
     }
 
+    // Benchmark mode: keep the overlay but ignore mouse/keyboard so settings cannot change mid-run
+    void lock_input() {
+        ImGuiIO& io = ImGui::GetIO();
+        io.ConfigFlags |= ImGuiConfigFlags_NoMouse;
+        io.ConfigFlags &= ~ImGuiConfigFlags_NavEnableKeyboard;
+    }
+
     // Custom Vulkan error check callback for ImGui
     void check_vk_result(VkResult err) {
         if (err == 0) return;
@@ -228,6 +237,8 @@ export namespace UI
             if (ImGui::CollapsingHeader("Raytracing Config", ImGuiTreeNodeFlags_DefaultOpen))
             {
                 ImGui::SliderInt("Max Bounces", &settings.maxBounces, 0, 10);
+                ImGui::Checkbox("Cluster LOD (rebuild to add/remove proxies)", &settings.lodEnabled);
+                ImGui::SliderFloat("LOD Threshold (px)", &settings.lodPixelThreshold, 0.5f, 32.0f);
             }
             
             if (ImGui::CollapsingHeader("Lighting", ImGuiTreeNodeFlags_DefaultOpen))
@@ -36,6 +36,9 @@ export namespace Render
     // Resize Flag
     bool framebufferResized = false;
 
+    // Benchmark mode: avoid V-Sync so frame times measure the renderer, not the display
+    bool preferImmediatePresent = false;
+
     const int WIDTH = 800;
     const int HEIGHT = 600;
 
@@ -107,6 +110,11 @@ export namespace Render
 
     VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
         // TODO: OPTIMIZATION: Using MAILBOX for triple buffering if available, otherwise FIFO (V-Sync)
+        if (preferImmediatePresent) {
+            for (const auto& availablePresentMode : availablePresentModes) {
+                if (availablePresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) return availablePresentMode;
+            }
+        }
         for (const auto& availablePresentMode : availablePresentModes) {
             if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) return availablePresentMode;
         }
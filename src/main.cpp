@@ -6,7 +6,10 @@
 #include <atomic>
 #include <cstring> // For memcmp/memcpy
 #include <algorithm> // For max(list)
+#include <chrono>
+#include <fstream>
 
+import Benchmark;
 import Engine;
 import Types;
 import Window;
@@ -18,13 +21,89 @@ bool frameAccumulationReset = true;
 // Helper to detect key toggle
 bool lastSpaceState = false;
 
-int main() {
+// Camera distance that frames the whole model
+float fit_distance(const MeshBounds& bounds) {
+    vec3 ext = sub(bounds.maxPos, bounds.minPos);
+    float maxDim = std::max({ext.x, ext.y, ext.z});
+    if (maxDim < 0.1f) maxDim = 5.0f;
+    return maxDim;
+}
+
+// Snapshot of the scripted subset of UI::settings (distance relative to the model)
+Benchmark::Keyframe capture_settings(int frame, float modelScale) {
+    Benchmark::Keyframe k;
+    k.frame = frame;
+    k.camAzimuth = UI::settings.camAzimuth;
+    k.camElevation = UI::settings.camElevation;
+    k.camDistance = UI::settings.camDistance / modelScale;
+    k.maxBounces = UI::settings.maxBounces;
+    std::copy(UI::settings.light1Color, UI::settings.light1Color + 3, k.light1Color);
+    std::copy(UI::settings.light1Pos, UI::settings.light1Pos + 3, k.light1Pos);
+    std::copy(UI::settings.light2Color, UI::settings.light2Color + 3, k.light2Color);
+    std::copy(UI::settings.light2Pos, UI::settings.light2Pos + 3, k.light2Pos);
+    return k;
+}
+
+void apply_settings(const Benchmark::Keyframe& k, float modelScale) {
+    UI::settings.camAzimuth = k.camAzimuth;
+    UI::settings.camElevation = k.camElevation;
+    UI::settings.camDistance = k.camDistance * modelScale;
+    UI::settings.maxBounces = k.maxBounces;
+    std::copy(k.light1Color, k.light1Color + 3, UI::settings.light1Color);
+    std::copy(k.light1Pos, k.light1Pos + 3, UI::settings.light1Pos);
+    std::copy(k.light2Color, k.light2Color + 3, UI::settings.light2Color);
+    std::copy(k.light2Pos, k.light2Pos + 3, UI::settings.light2Pos);
+}
+
+int main(int argc, char** argv) {
+    // ---------------------------------------------------------
+    // COMMAND LINE
+    // ---------------------------------------------------------
+    Benchmark::Options bench;
+    if (!Benchmark::parse_args(argc, argv, bench)) return 1;
+
+    std::vector<Benchmark::Keyframe> benchKeys;
+    if (bench.enabled) {
+        if (bench.modelPath.size() >= sizeof(UI::settings.modelPath)) {
+            std::cerr << "[Benchmark] Model path too long.\n";
+            return 1;
+        }
+        std::strncpy(UI::settings.modelPath, bench.modelPath.c_str(), sizeof(UI::settings.modelPath) - 1);
+
+        // Scripts may omit light columns; those fall back to the default settings
+        Benchmark::Keyframe base = capture_settings(0, UI::settings.camDistance);
+        base.camDistance = 1.0f;
+        if (bench.scriptPath.empty()) {
+            benchKeys = Benchmark::default_orbit(base, bench.frames);
+        } else if (!Benchmark::load_script(bench.scriptPath, base, benchKeys)) {
+            return 1;
+        } else if (!bench.framesGiven) {
+            // Replay the whole script and nothing more (recordings hold one keyframe per frame)
+            bench.frames = benchKeys.back().frame + 1;
+        }
+
+        UI::settings.lodEnabled = bench.lod;
+        UI::settings.lodPixelThreshold = bench.lodPixelThreshold;
+        Render::preferImmediatePresent = true;
+    }
+
+    std::ofstream recordFile;
+    if (!bench.recordPath.empty()) {
+        recordFile.open(bench.recordPath);
+        if (!recordFile.is_open()) {
+            std::cerr << "[Benchmark] Failed to open record file: " << bench.recordPath << "\n";
+            return 1;
+        }
+        recordFile << "# frame azimuth elevation distance bounces l1.rgb l1.xyz l2.rgb l2.xyz\n";
+    }
+
     // ---------------------------------------------------------
     // VULKAN INIT
     // ---------------------------------------------------------
     // Exceptions are removed in favor of explicit abort() in modules
     Render::init_vulkan();
     UI::init();
+    if (bench.enabled) UI::lock_input();
 
     // ---------------------------------------------------------
     // DATA CONTAINERS
@@ -42,46 +121,72 @@ int main() {
         std::vector<RaytraceTriangle> gpu_triangles;
         std::vector<BVHNode> nodes;
         std::vector<uint> indices;
+        uint lodTriangles = 0;
+        Benchmark::LoadTimings timings;
     } pendingData;
     
     std::atomic<bool> isLoading{false};
 
     // Helper lambda for loading logic (Now designed to run on a separate thread)
-    auto load_model_task = [&](std::string path) -> bool {
+    auto load_model_task = [&](std::string path, bool buildLod) -> bool {
         std::cout << "[Loader] Thread started for: " << path << std::endl;
+        pendingData.timings = {};
+        auto stageStart = std::chrono::steady_clock::now();
         
         // 1. Load GLTF/GLB (Heavy IO)
         if (!Core::load_mesh(path, pendingData.triangles, pendingData.obj.bounds)) {
             std::cerr << "[Loader] Failed to load mesh.\n";
             return false;
         }
+        pendingData.timings.meshMs = Benchmark::elapsed_ms(stageStart);
 
         // 2. Calc Bounds (Fast)
+        stageStart = std::chrono::steady_clock::now();
         if(pendingData.obj.bounds == MeshBounds({0,0,0},{0,0,0}))
             Core::load_bounds(pendingData.triangles, pendingData.obj.bounds);
+        pendingData.timings.boundsMs = Benchmark::elapsed_ms(stageStart);
 
         // 3. Cache & Quantize (CPU Heavy)
+        stageStart = std::chrono::steady_clock::now();
         Core::load_cache(pendingData.triangles, pendingData.obj);
+        pendingData.timings.cacheMs = Benchmark::elapsed_ms(stageStart);
         
         // 4. Build BVH (Very CPU Heavy - O(N log N))
+        stageStart = std::chrono::steady_clock::now();
         Core::build_bvh(pendingData.obj, pendingData.indices, pendingData.nodes);
+        pendingData.timings.bvhMs = Benchmark::elapsed_ms(stageStart);
         
         // Prepare GPU format data
+        stageStart = std::chrono::steady_clock::now();
         pendingData.gpu_triangles = Render::write_in_order(pendingData.obj.mesh, pendingData.indices);
+        pendingData.timings.gpuFormatMs = Benchmark::elapsed_ms(stageStart);
+
+        // 5. Cluster LOD proxies, appended after the full resolution triangles
+        stageStart = std::chrono::steady_clock::now();
+        pendingData.lodTriangles = buildLod ? Core::build_lod(pendingData.obj, pendingData.nodes, pendingData.gpu_triangles) : 0;
+        pendingData.timings.lodMs = Benchmark::elapsed_ms(stageStart);
         
         return true;
     };
 
+    Benchmark::Report benchReport;
+    float modelScale = UI::settings.camDistance;
+
     // Initial Load (Synchronous for the first start)
-    if (load_model_task(UI::settings.modelPath)) {
+    if (load_model_task(UI::settings.modelPath, UI::settings.lodEnabled)) {
          meshBounds = pendingData.obj.bounds;
+         auto uploadStart = std::chrono::steady_clock::now();
          Render::reload_buffers(pendingData.gpu_triangles, pendingData.nodes);
+         pendingData.timings.uploadMs = Benchmark::elapsed_ms(uploadStart);
          std::cout << "[Loader] Initial load complete.\n";
 
-         vec3 ext = sub(meshBounds.maxPos, meshBounds.minPos);
-         float maxDim = std::max({ext.x, ext.y, ext.z});
-         if (maxDim < 0.1f) maxDim = 5.0f;
-         UI::settings.camDistance = maxDim;
+         modelScale = fit_distance(meshBounds);
+         UI::settings.camDistance = modelScale;
+
+         benchReport.load = pendingData.timings;
+         benchReport.triangles = pendingData.gpu_triangles.size() - pendingData.lodTriangles;
+         benchReport.lodTriangles = pendingData.lodTriangles;
+         benchReport.bvhNodes = pendingData.nodes.size();
          // -------------------------
          
          // Clear RAM used for loading immediately after upload
@@ -90,6 +195,11 @@ int main() {
          pendingData.nodes.clear();
          pendingData.indices.clear();
          pendingData.obj.mesh.clear();
+    } else if (bench.enabled) {
+        std::cerr << "[Benchmark] Failed to load model: " << bench.modelPath << "\n";
+        UI::cleanup();
+        Render::cleanup();
+        return 1;
     }
 
     // ---------------------------------------------------------
@@ -101,6 +211,14 @@ int main() {
     // MAIN LOOP
     // ---------------------------------------------------------
     std::cout << "Starting Main Loop...\n";
+
+    // Benchmark bookkeeping: warmup frames replay keyframe 0, then the script runs with a fixed seed
+    int benchFrame = -bench.warmup;
+    int benchRetries = 0;
+    int recordFrame = 0;
+    std::vector<double> frameTimes;
+    frameTimes.reserve(bench.frames);
+    auto frameStart = std::chrono::steady_clock::now();
     
     while (!glfwWindowShouldClose(Render::window)) {
         glfwPollEvents();
@@ -123,9 +241,37 @@ int main() {
                       << Render::swapChainExtent.height << "\n";
             
             // Skip drawing this frame to prevent validation errors during transition
+            frameStart = std::chrono::steady_clock::now();
             continue; 
         }
 
+        // Benchmark Mode: no input, no wall-clock animation, no hot reload
+        if (bench.enabled) {
+            if (benchFrame >= bench.frames) break;
+
+            apply_settings(Benchmark::sample(benchKeys, std::max(benchFrame, 0)), modelScale);
+            if (benchFrame == 0) Render::frameIndex = bench.seed;
+
+            bool presented = Render::draw_frame(meshBounds);
+
+            double frameMs = Benchmark::elapsed_ms(frameStart);
+            frameStart = std::chrono::steady_clock::now();
+            if (!presented) {
+                // Swapchain out of date: rebuild it and retry the same frame, without relying on a resize callback
+                Render::framebufferResized = true;
+                if (++benchRetries > Benchmark::MAX_PRESENT_RETRIES) {
+                    std::cerr << "[Benchmark] Swapchain stayed out of date, stopping at frame " << benchFrame << "\n";
+                    break;
+                }
+                continue;
+            }
+            benchRetries = 0;
+
+            if (benchFrame >= 0) frameTimes.push_back(frameMs);
+            benchFrame++;
+            continue;
+        }
+
         // 1. Toggle Mode (Spacebar)
         bool currentSpaceState = glfwGetKey(Render::window, GLFW_KEY_SPACE) == GLFW_PRESS;
         if (currentSpaceState && !lastSpaceState) {
@@ -180,7 +326,7 @@ int main() {
             
             // Launch loading in a separate thread
             // We pass modelPath by value to avoid race conditions if UI changes it immediately
-            loadingFuture = std::async(std::launch::async, load_model_task, std::string(UI::settings.modelPath));
+            loadingFuture = std::async(std::launch::async, load_model_task, std::string(UI::settings.modelPath), UI::settings.lodEnabled);
         }
 
         // 4. Check if Async Loading Finished
@@ -198,12 +344,9 @@ int main() {
                 Render::reload_buffers(pendingData.gpu_triangles, pendingData.nodes);
                 meshBounds = pendingData.obj.bounds;
 
-                vec3 ext = sub(meshBounds.maxPos, meshBounds.minPos);
-                float maxDim = std::max({ext.x, ext.y, ext.z});
-                if (maxDim < 0.1f) maxDim = 5.0f;
-                
                 // Set distance relative to object size
-                UI::settings.camDistance = maxDim; 
+                modelScale = fit_distance(meshBounds);
+                UI::settings.camDistance = modelScale; 
                 
                 // Reset angles for a nice initial view
                 if (!UI::settings.manualCamera) {
@@ -221,7 +364,12 @@ int main() {
             pendingData.obj.mesh.clear();
         }
 
-        // 4. Draw
+        // 5. Record camera/light state so the session can be replayed with --script
+        if (recordFile.is_open()) {
+            recordFile << Benchmark::format_keyframe(capture_settings(recordFrame++, modelScale)) << "\n";
+        }
+
+        // 6. Draw
         Render::draw_frame(meshBounds); 
     }
 
@@ -229,9 +377,27 @@ int main() {
     // CLEANUP
     // ---------------------------------------------------------
     vkDeviceWaitIdle(Render::device); 
+
+    int exitCode = 0;
+    if (bench.enabled) {
+        benchReport.modelPath = bench.modelPath;
+        benchReport.scriptPath = bench.scriptPath;
+        benchReport.frames = bench.frames;
+        benchReport.warmup = bench.warmup;
+        benchReport.seed = bench.seed;
+        benchReport.lod = bench.lod;
+        benchReport.lodPixelThreshold = UI::settings.lodPixelThreshold;
+        benchReport.width = Render::swapChainExtent.width;
+        benchReport.height = Render::swapChainExtent.height;
+        benchReport.completed = static_cast<int>(frameTimes.size()) == bench.frames;
+        benchReport.frameTimes = Benchmark::compute_stats(frameTimes);
+
+        if (!benchReport.completed) std::cerr << "[Benchmark] Window closed before the run finished.\n";
+        if (!Benchmark::write_report(bench.outputPath, benchReport) || !benchReport.completed) exitCode = 1;
+    }
     
     UI::cleanup();
     Render::cleanup();
 
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
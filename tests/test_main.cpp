@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <cmath>
+#include <string>
 
 // Import your modules
 import Types;
 import Engine;
+import Benchmark;
 
 // --- Test Math Helpers (Types.cppm) ---
 
@@ -73,4 +75,254 @@ TEST(EngineTests, CacheGenerationEmpty) {
     // Should return false or handle empty gracefully
     bool result = Core::load_cache(empty_tris, obj);
     EXPECT_FALSE(result);
-}
\ No newline at end of file
+}
+
+TEST(EngineTests, ClusterLodProxies) {
+    // 64x64 quad grid = 8192 triangles on the z = 0 plane
+    std::vector<Triangle> triangles;
+    const int n = 64;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            vec3 a = {(float)x, (float)y, 0.0f}, b = {(float)x + 1, (float)y, 0.0f};
+            vec3 c = {(float)x, (float)y + 1, 0.0f}, d = {(float)x + 1, (float)y + 1, 0.0f};
+            triangles.push_back({a, b, d});
+            triangles.push_back({a, d, c});
+        }
+    }
+
+    Object obj;
+    ASSERT_TRUE(Core::load_bounds(triangles, obj.bounds));
+    ASSERT_TRUE(Core::load_cache(triangles, obj));
+
+    std::vector<uint> indices;
+    std::vector<BVHNode> nodes;
+    Core::build_bvh(obj, indices, nodes);
+
+    // Source triangles in BVH order, as uploaded to the GPU
+    std::vector<RaytraceTriangle> gpu_triangles;
+    for (uint idx : indices) {
+        const CachedTriangle& tri = obj.mesh[idx];
+        gpu_triangles.push_back({ tri.v1, tri.v2, tri.v3, tri.normal });
+    }
+
+    const size_t sourceNodes = nodes.size();
+    uint added = Core::build_lod(obj, nodes, gpu_triangles);
+
+    ASSERT_GT(added, 0u);
+    EXPECT_EQ(gpu_triangles.size(), triangles.size() + added);
+    EXPECT_LT(added, triangles.size() / 4);
+
+    // Every proxy BVH lives after the source BVH, its leaves point past the source triangles
+    // and its boxes and vertices stay inside the cluster node and on the z = 0 plane
+    auto inside = [](const u16vec3& v, const BVHNode& box) {
+        return v.x >= box.aabbMin.x && v.x <= box.aabbMax.x &&
+               v.y >= box.aabbMin.y && v.y <= box.aabbMax.y &&
+               v.z >= box.aabbMin.z && v.z <= box.aabbMax.z;
+    };
+
+    // Face-on ray (along z) through (x, y) hits the triangle when the point lies in its xy projection
+    auto covers = [](const RaytraceTriangle& t, double x, double y) {
+        auto edge = [&](const u16vec3& a, const u16vec3& b) {
+            return (double(b.x) - a.x) * (y - a.y) - (double(b.y) - a.y) * (x - a.x);
+        };
+        double e0 = edge(t.v1, t.v2), e1 = edge(t.v2, t.v3), e2 = edge(t.v3, t.v1);
+        return (e0 >= 0 && e1 >= 0 && e2 >= 0) || (e0 <= 0 && e1 <= 0 && e2 <= 0);
+    };
+
+    uint linked = 0;
+    uint clusters = 0;
+    for (uint nodeIdx = 0; nodeIdx < sourceNodes; ++nodeIdx) {
+        const BVHNode& node = nodes[nodeIdx];
+        if ((node.triCount & BVH_LOD_FLAG) == 0) continue;
+        EXPECT_LE(node.lodCount, Core::LOD_MAX_PROXY);
+        EXPECT_GE(node.triCount & ~BVH_LOD_FLAG, sourceNodes);
+        clusters++;
+
+        std::vector<RaytraceTriangle> proxies;
+        std::vector<uint> stack = { node.triCount & ~BVH_LOD_FLAG };
+        while (!stack.empty()) {
+            uint idx = stack.back();
+            stack.pop_back();
+            ASSERT_LT(idx, nodes.size());
+            const BVHNode& proxyNode = nodes[idx];
+            EXPECT_TRUE(inside(proxyNode.aabbMin, node) && inside(proxyNode.aabbMax, node));
+            ASSERT_EQ(proxyNode.triCount & BVH_LOD_FLAG, 0u);
+
+            if (proxyNode.triCount == 0) {
+                stack.push_back(proxyNode.leftFirst);
+                stack.push_back(proxyNode.leftFirst + 1);
+                continue;
+            }
+
+            EXPECT_LE(proxyNode.triCount, Core::LOD_PROXY_LEAF);
+            EXPECT_GE(proxyNode.leftFirst, triangles.size());
+            ASSERT_LE(proxyNode.leftFirst + proxyNode.triCount, gpu_triangles.size());
+
+            for (uint i = 0; i < proxyNode.triCount; ++i) {
+                const RaytraceTriangle& proxy = gpu_triangles[proxyNode.leftFirst + i];
+                for (const u16vec3& v : { proxy.v1, proxy.v2, proxy.v3 }) {
+                    EXPECT_TRUE(inside(v, node));
+                    EXPECT_TRUE(inside(v, proxyNode));
+                    EXPECT_EQ(v.z, 0);
+                }
+                proxies.push_back(proxy);
+            }
+        }
+        EXPECT_EQ(proxies.size(), node.lodCount);
+        linked += static_cast<uint>(proxies.size());
+
+        // Face-on rays through points spread over the cluster's own triangles must hit its proxy
+        const double weights[4][3] = { {1.0 / 3, 1.0 / 3, 1.0 / 3}, {0.8, 0.1, 0.1}, {0.1, 0.8, 0.1}, {0.1, 0.1, 0.8} };
+        Core::SubtreeRange range = Core::subtree_range(nodeIdx, nodes);
+        uint rays = 0, hits = 0;
+        for (uint i = 0; i < range.count; ++i) {
+            const CachedTriangle& tri = obj.mesh[indices[range.first + i]];
+            for (const auto& w : weights) {
+                double x = w[0] * tri.v1.x + w[1] * tri.v2.x + w[2] * tri.v3.x;
+                double y = w[0] * tri.v1.y + w[1] * tri.v2.y + w[2] * tri.v3.y;
+                rays++;
+                for (const auto& proxy : proxies) {
+                    if (covers(proxy, x, y)) { hits++; break; }
+                }
+            }
+        }
+        EXPECT_GE(hits, rays * 95 / 100) << "cluster " << nodeIdx << " covers " << hits << " of " << rays;
+    }
+    EXPECT_GT(clusters, 0u);
+    EXPECT_EQ(linked, added);
+}
+
+TEST(EngineTests, ClusterLodSkipsSmallMesh) {
+    // 8x3 quad grid = 48 triangles, below LOD_CLUSTER_SIZE
+    std::vector<Triangle> triangles;
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            vec3 a = {(float)x, (float)y, 0.0f}, b = {(float)x + 1, (float)y, 0.0f};
+            vec3 c = {(float)x, (float)y + 1, 0.0f}, d = {(float)x + 1, (float)y + 1, 0.0f};
+            triangles.push_back({a, b, d});
+            triangles.push_back({a, d, c});
+        }
+    }
+    ASSERT_LT(triangles.size(), Core::LOD_CLUSTER_SIZE);
+
+    Object obj;
+    ASSERT_TRUE(Core::load_bounds(triangles, obj.bounds));
+    ASSERT_TRUE(Core::load_cache(triangles, obj));
+
+    std::vector<uint> indices;
+    std::vector<BVHNode> nodes;
+    Core::build_bvh(obj, indices, nodes);
+
+    std::vector<RaytraceTriangle> gpu_triangles;
+    for (uint idx : indices) {
+        const CachedTriangle& tri = obj.mesh[idx];
+        gpu_triangles.push_back({ tri.v1, tri.v2, tri.v3, tri.normal });
+    }
+    EXPECT_EQ(Core::build_lod(obj, nodes, gpu_triangles), 0u);
+    EXPECT_EQ(gpu_triangles.size(), triangles.size());
+    for (const auto& node : nodes) EXPECT_EQ(node.triCount & BVH_LOD_FLAG, 0u);
+}
+
+TEST(EngineTests, SubtreeRangeWalksLodNodes) {
+    std::vector<BVHNode> nodes(3);
+    nodes[0].leftFirst = 1;
+    nodes[0].triCount = BVH_LOD_FLAG | 100; // Internal node with proxy BVH at 100
+    nodes[0].lodCount = 4;
+    nodes[1].leftFirst = 0;
+    nodes[1].triCount = 3;
+    nodes[2].leftFirst = 3;
+    nodes[2].triCount = 5;
+
+    Core::SubtreeRange range = Core::subtree_range(0, nodes);
+    EXPECT_EQ(range.first, 0u);
+    EXPECT_EQ(range.count, 8u);
+}
+
+// --- Test Benchmark Logic (Benchmark.cppm) ---
+
+TEST(BenchmarkTests, FrameStatsPercentiles) {
+    std::vector<double> samples;
+    for (int i = 100; i >= 1; --i) samples.push_back(static_cast<double>(i));
+
+    Benchmark::FrameStats stats = Benchmark::compute_stats(samples);
+
+    EXPECT_EQ(stats.count, 100u);
+    EXPECT_DOUBLE_EQ(stats.avgMs, 50.5);
+    EXPECT_DOUBLE_EQ(stats.minMs, 1.0);
+    EXPECT_DOUBLE_EQ(stats.maxMs, 100.0);
+    EXPECT_DOUBLE_EQ(stats.p50Ms, 50.0);
+    EXPECT_DOUBLE_EQ(stats.p95Ms, 95.0);
+    EXPECT_DOUBLE_EQ(stats.p99Ms, 99.0);
+}
+
+TEST(BenchmarkTests, KeyframeParseAndSample) {
+    Benchmark::Keyframe base;
+    base.light1Color[0] = 0.25f;
+
+    Benchmark::Keyframe a, b, bad;
+    ASSERT_TRUE(Benchmark::parse_keyframe("0 0.0 0.5 1.0 2 # start", base, a));
+    ASSERT_TRUE(Benchmark::parse_keyframe("10 1.0 0.5 3.0 4", base, b));
+    EXPECT_FALSE(Benchmark::parse_keyframe("5 1.0 0.5", base, bad));
+    EXPECT_FALSE(Benchmark::parse_keyframe("20 1.0 0.5 3.0 4 1 1", base, bad));
+
+    // Omitted light columns come from the base settings
+    EXPECT_FLOAT_EQ(a.light1Color[0], 0.25f);
+
+    Benchmark::Keyframe mid = Benchmark::sample({ a, b }, 5);
+    EXPECT_EQ(mid.frame, 5);
+    EXPECT_FLOAT_EQ(mid.camAzimuth, 0.5f);
+    EXPECT_FLOAT_EQ(mid.camDistance, 2.0f);
+    EXPECT_EQ(mid.maxBounces, 2);
+}
+
+TEST(BenchmarkTests, ParseArgs) {
+    struct Case {
+        std::vector<std::string> args;
+        bool accepted;
+    };
+    const std::vector<Case> cases = {
+        { {}, true },
+        { { "--record", "rec.txt" }, true },
+        { { "--benchmark", "m.glb" }, true },
+        { { "--benchmark", "m.glb", "--script", "s.txt", "--frames", "10", "--warmup", "0", "--seed", "3" }, true },
+        { { "--benchmark", "m.glb", "--lod", "off", "--lod-threshold", "2.5", "--output", "-" }, true },
+        { { "--frames", "10" }, false },                             // Benchmark-only option without --benchmark
+        { { "--lod", "on" }, false },
+        { { "--benchmark", "m.glb", "--record", "rec.txt" }, false },
+        { { "--benchmark", "m.glb", "--lod", "yes" }, false },
+        { { "--benchmark", "m.glb", "--lod-threshold", "0" }, false },
+        { { "--benchmark", "m.glb", "--frames", "0" }, false },
+        { { "--benchmark", "m.glb", "--frames" }, false },           // Missing value
+        { { "--benchmark", "m.glb", "--unknown", "1" }, false },
+    };
+
+    for (const Case& c : cases) {
+        std::vector<std::string> storage = { "RayTracingDemo" };
+        storage.insert(storage.end(), c.args.begin(), c.args.end());
+        std::vector<char*> argv;
+        for (std::string& arg : storage) argv.push_back(arg.data());
+
+        Benchmark::Options options;
+        std::string line;
+        for (const std::string& arg : c.args) line += arg + " ";
+        EXPECT_EQ(Benchmark::parse_args(static_cast<int>(argv.size()), argv.data(), options), c.accepted) << line;
+    }
+
+    // framesGiven tells an explicit --frames apart from the default
+    Benchmark::Options defaults, explicitFrames;
+    std::vector<std::string> a = { "RayTracingDemo", "--benchmark", "m.glb", "--lod", "off" };
+    std::vector<std::string> b = { "RayTracingDemo", "--benchmark", "m.glb", "--frames", "42" };
+    std::vector<char*> argvA, argvB;
+    for (std::string& arg : a) argvA.push_back(arg.data());
+    for (std::string& arg : b) argvB.push_back(arg.data());
+
+    ASSERT_TRUE(Benchmark::parse_args(static_cast<int>(argvA.size()), argvA.data(), defaults));
+    EXPECT_TRUE(defaults.enabled);
+    EXPECT_EQ(defaults.modelPath, "m.glb");
+    EXPECT_FALSE(defaults.framesGiven);
+    EXPECT_FALSE(defaults.lod);
+
+    ASSERT_TRUE(Benchmark::parse_args(static_cast<int>(argvB.size()), argvB.data(), explicitFrames));
+    EXPECT_TRUE(explicitFrames.framesGiven);
+    EXPECT_EQ(explicitFrames.frames, 42);
+}